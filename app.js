@@ -10,6 +10,12 @@ class ESP32PeriodicTester {
         this.audioContext = null;
         this.oscillator = null;
         this.gainNode = null;
+        this.pulseNode = null;         // AudioWorkletによるパルス生成ノード
+        this.audioSchedule = null;
+        
+        // BLE送信用クロックWorker
+        this.clockWorker = null;
+        this.bleWriteInProgress = false;
         
         // 共通状態
         this.isConnected = false;
@@ -314,6 +320,11 @@ class ESP32PeriodicTester {
         if (this.gainNode) {
             this.gainNode = null;
         }
+        if (this.pulseNode) {
+            this.pulseNode.port.postMessage({ type: 'stop' });
+            this.pulseNode.disconnect();
+            this.pulseNode = null;
+        }
         // AudioContextは再利用のため残しておく
     }
     
@@ -358,7 +369,7 @@ class ESP32PeriodicTester {
                 this.sendFirstSignal();
             } else if (this.connectionMethod === 'audio') {
                 // オーディオ接続の場合
-                this.startAudioPeriodicTest();
+                await this.startAudioPeriodicTest();
             }
             
         } catch (error) {
@@ -367,12 +378,117 @@ class ESP32PeriodicTester {
         }
     }
     
-    startAudioPeriodicTest() {
+    async startAudioPeriodicTest() {
+        // AudioWorkletが使えればサンプル単位でスケジュール、使えなければ従来方式
+        if (await this.initializePulseWorklet()) {
+            this.startWorkletAudioTest();
+            return;
+        }
+        
         this.testStartTime = performance.now();
         this.sendFirstAudioSignal();
         this.scheduleNextAudioSignal();
     }
     
+    async initializePulseWorklet() {
+        if (this.pulseNode) return true;
+        if (!this.audioContext || !this.audioContext.audioWorklet || typeof AudioWorkletNode === 'undefined') {
+            return false;
+        }
+        
+        try {
+            await this.audioContext.audioWorklet.addModule('pulse_worklet.js');
+            this.pulseNode = new AudioWorkletNode(this.audioContext, 'pulse-generator', {
+                numberOfInputs: 0,
+                outputChannelCount: [2]
+            });
+            this.pulseNode.port.onmessage = (event) => this.onWorkletMessage(event.data);
+            this.pulseNode.connect(this.audioContext.destination);
+            this.log('✓ AudioWorkletでサンプル単位のパルス生成を使用します', 'success');
+            return true;
+        } catch (error) {
+            this.log(`AudioWorklet初期化失敗: ${error.message}（従来方式を使用）`, 'info');
+            this.pulseNode = null;
+            return false;
+        }
+    }
+    
+    startWorkletAudioTest() {
+        // 少し先の時刻を開始点にして、最初のパルスもサンプル単位で配置する
+        const startTime = this.audioContext.currentTime + 0.05;
+        this.audioSchedule = {
+            startTime: startTime,
+            period: this.periodicSettings.period / 1000
+        };
+        this.testStartTime = this.contextToPerformanceTime(startTime);
+        
+        this.pulseNode.port.postMessage({
+            type: 'start',
+            startTime: startTime,
+            period: this.audioSchedule.period,
+            count: this.periodicSettings.count,
+            frequency: 1000, // 1kHz
+            duration: 0.1,   // 100ms
+            gain: 0.1
+        });
+    }
+    
+    onWorkletMessage(message) {
+        if (!this.isTestRunning || !this.audioSchedule) return;
+        
+        if (message.type === 'pulse') {
+            const sequence = message.sequence;
+            const intendedContextTime = this.audioSchedule.startTime + sequence * this.audioSchedule.period;
+            const sampleRate = this.audioContext.sampleRate;
+            const actualContextTime = message.frame / sampleRate;
+            
+            // performance.now()への変換は表示用（変換の揺らぎを含む）
+            // ずれの計算はオーディオクロック上のフレーム位置 (ms) で行う
+            this.sendTimes.push({
+                sequence: sequence,
+                sendTime: Date.now(),
+                performanceTime: performance.now(),
+                intendedTime: this.contextToPerformanceTime(intendedContextTime),
+                actualTime: this.contextToPerformanceTime(actualContextTime),
+                audioIntendedTime: message.scheduledFrame / sampleRate * 1000,
+                audioActualTime: message.frame / sampleRate * 1000
+            });
+            
+            this.currentSignalIndex = sequence + 1;
+            this.updateProgress();
+            this.log(`音声信号送信 [${sequence + 1}/${this.periodicSettings.count}]`, 'info');
+            this.simulateAudioResult(sequence);
+        } else if (message.type === 'skipped') {
+            // 予定時刻にパルスを描画できなかった（クライアント側の欠落）
+            const sequence = message.sequence;
+            const intendedContextTime = this.audioSchedule.startTime + sequence * this.audioSchedule.period;
+            this.sendTimes.push({
+                sequence: sequence,
+                sendTime: Date.now(),
+                performanceTime: performance.now(),
+                intendedTime: this.contextToPerformanceTime(intendedContextTime),
+                failed: true
+            });
+            this.currentSignalIndex = Math.max(this.currentSignalIndex, sequence + 1);
+            this.updateProgress();
+            this.log(`音声信号欠落 [${sequence + 1}/${this.periodicSettings.count}]`, 'error');
+        } else if (message.type === 'done') {
+            this.audioSchedule = null;
+            this.finishAudioSending();
+        }
+    }
+    
+    // AudioContext時間(秒)を出力時刻ベースのperformance.now()時間(ms)に変換
+    contextToPerformanceTime(contextTime) {
+        if (typeof this.audioContext.getOutputTimestamp === 'function') {
+            const stamp = this.audioContext.getOutputTimestamp();
+            if (stamp.performanceTime) {
+                return stamp.performanceTime + (contextTime - stamp.contextTime) * 1000;
+            }
+        }
+        return performance.now() + (contextTime - this.audioContext.currentTime) * 1000;
+    }
+    
     async sendFirstAudioSignal() {
         await this.sendAudioSignal();
     }
@@ -380,11 +496,14 @@ class ESP32PeriodicTester {
     async sendAudioSignal() {
         const currentTime = Date.now();
         const sequence = this.currentSignalIndex;
+        const actualTime = performance.now();
         
         this.sendTimes.push({
             sequence: sequence,
             sendTime: currentTime,
-            performanceTime: performance.now()
+            performanceTime: actualTime,
+            intendedTime: this.testStartTime + sequence * this.periodicSettings.period,
+            actualTime: actualTime
         });
         
         // オーディオ信号生成 (1kHz、100ms duration)
@@ -516,6 +635,7 @@ class ESP32PeriodicTester {
     
     async finishAudioSending() {
         this.log('全音声信号送信完了', 'info');
+        this.logClientTimingSummary();
         await this.sleep(100);
         this.stopTest();
     }
@@ -532,21 +652,89 @@ class ESP32PeriodicTester {
     
     async sendFirstSignal() {
         this.testStartTime = performance.now();
+        
+        // Workerクロックが使えれば絶対デッドラインで送信、使えなければ従来方式
+        if (this.startClockWorker()) {
+            return;
+        }
+        
         await this.sendPeriodicSignal();
         
         // 次の信号をスケジュール
         this.scheduleNextSignal();
     }
     
-    async sendPeriodicSignal() {
+    startClockWorker() {
+        if (typeof Worker === 'undefined') return false;
+        
+        try {
+            this.clockWorker = new Worker('clock_worker.js');
+        } catch (error) {
+            this.log(`Workerクロック起動失敗: ${error.message}（従来方式を使用）`, 'info');
+            this.clockWorker = null;
+            return false;
+        }
+        
+        this.clockWorker.onmessage = (event) => this.onClockTick(event.data);
+        this.clockWorker.postMessage({
+            type: 'start',
+            startTime: performance.timeOrigin + this.testStartTime,
+            period: this.periodicSettings.period,
+            count: this.periodicSettings.count
+        });
+        return true;
+    }
+    
+    stopClockWorker() {
+        if (this.clockWorker) {
+            this.clockWorker.postMessage({ type: 'stop' });
+            this.clockWorker.terminate();
+            this.clockWorker = null;
+        }
+    }
+    
+    onClockTick(message) {
+        if (!this.isTestRunning) return;
+        
+        if (message.type === 'tick') {
+            // Workerの絶対時刻をこのページのperformance.now()時間に変換
+            const intendedTime = message.deadline - performance.timeOrigin;
+            
+            // メインスレッド停止後にtickが連続して届いた場合、書き込み中のtickは送信せず欠落として記録
+            if (this.bleWriteInProgress) {
+                this.sendTimes.push({
+                    sequence: message.sequence,
+                    sendTime: Date.now(),
+                    performanceTime: performance.now(),
+                    intendedTime: intendedTime,
+                    failed: true
+                });
+                this.currentSignalIndex = message.sequence + 1;
+                this.updateProgress();
+                this.log(`信号送信スキップ [${message.sequence + 1}/${this.periodicSettings.count}] (前回の書き込み中)`, 'error');
+                return;
+            }
+            
+            this.sendPeriodicSignal(message.sequence, intendedTime);
+        } else if (message.type === 'done') {
+            this.stopClockWorker();
+            this.finishSending();
+        }
+    }
+    
+    async sendPeriodicSignal(sequence = this.currentSignalIndex,
+                             intendedTime = this.testStartTime + sequence * this.periodicSettings.period) {
         const currentTime = Date.now();
-        const sequence = this.currentSignalIndex;
+        const actualTime = performance.now();
         
-        this.sendTimes.push({
+        const sendRecord = {
             sequence: sequence,
             sendTime: currentTime,
-            performanceTime: performance.now()
-        });
+            performanceTime: actualTime,
+            intendedTime: intendedTime,
+            actualTime: actualTime
+        };
+        this.sendTimes.push(sendRecord);
         
         const command = new ArrayBuffer(11);
         const view = new DataView(command);
@@ -554,12 +742,21 @@ class ESP32PeriodicTester {
         view.setUint16(1, sequence, true);
         view.setBigUint64(3, BigInt(currentTime), true);
         
-        await this.commandCharacteristic.writeValue(command);
+        this.bleWriteInProgress = true;
+        try {
+            await this.commandCharacteristic.writeValue(command);
+            sendRecord.writeCompleteTime = performance.now();
+            this.log(`信号送信 [${sequence + 1}/${this.periodicSettings.count}]`, 'info');
+        } catch (error) {
+            // 送信失敗はクライアント/伝送ずれの分解から除外する
+            sendRecord.failed = true;
+            this.log(`信号送信失敗 [${sequence + 1}/${this.periodicSettings.count}]: ${error.message}`, 'error');
+        } finally {
+            this.bleWriteInProgress = false;
+        }
         
-        this.currentSignalIndex++;
+        this.currentSignalIndex = sequence + 1;
         this.updateProgress();
-        
-        this.log(`信号送信 [${sequence + 1}/${this.periodicSettings.count}]`, 'info');
     }
     
     scheduleNextSignal() {
@@ -612,6 +809,7 @@ class ESP32PeriodicTester {
     
     async finishSending() {
         this.log('全信号送信完了 - 結果データ取得中...', 'info');
+        this.logClientTimingSummary();
         
         // 少し待ってからESP32に結果を要求
         await this.sleep(100);
@@ -914,6 +1112,13 @@ class ESP32PeriodicTester {
         this.isTestRunning = false;
         this.responseHandler = null;
         
+        // Workerクロック・AudioWorkletのスケジュールを停止
+        this.stopClockWorker();
+        if (this.pulseNode) {
+            this.pulseNode.port.postMessage({ type: 'stop' });
+        }
+        this.audioSchedule = null;
+        
         // タイマーをクリア
         if (this.periodicTimer) {
             clearTimeout(this.periodicTimer);
@@ -1028,22 +1233,74 @@ class ESP32PeriodicTester {
         this.log('結果をクリアしました', 'info');
     }
     
+    // クライアント側の送信ずれ（ESP32側の偏差と同じ定義）
+    // ESP32は届いた信号だけを順に数えるため、送信に成功した記録のi番目をESP32の測定値i番目に対応させ、
+    // 最初に届いた信号を基準に (実送信時刻 - 基準) - i × 周期 を求める
+    // AudioWorkletのパルスはオーディオクロック (フレーム位置) で比較し、時刻変換の揺らぎを含めない
+    computeClientDeviations() {
+        const delivered = this.sendTimes
+            .filter(record => record.intendedTime !== undefined && !record.failed)
+            .sort((a, b) => a.sequence - b.sequence);
+        if (delivered.length === 0) return [];
+        
+        const clock = (record) => record.audioActualTime !== undefined
+            ? { intended: record.audioIntendedTime, actual: record.audioActualTime }
+            : { intended: record.intendedTime, actual: record.actualTime };
+        
+        const first = clock(delivered[0]);
+        const period = this.periodicSettings.period;
+        return delivered.map((record, index) => {
+            const { intended, actual } = clock(record);
+            return {
+                sequence: record.sequence,
+                intendedTime: intended - first.intended,
+                actualTime: actual - first.actual,
+                clientDeviation: (actual - first.actual) - index * period
+            };
+        });
+    }
+    
+    logClientTimingSummary() {
+        const failed = this.sendTimes.filter(record => record.failed).length;
+        if (failed > 0) {
+            this.log(`クライアント側で送信できなかった信号: ${failed}件（ずれの分解から除外）`, 'error');
+        }
+        
+        const deviations = this.computeClientDeviations().map(d => Math.abs(d.clientDeviation));
+        if (deviations.length === 0) return;
+        
+        const avg = deviations.reduce((a, b) => a + b, 0) / deviations.length;
+        const max = Math.max(...deviations);
+        this.log(`クライアント送信ずれ: 平均 ${avg.toFixed(3)}ms, 最大 ${max.toFixed(3)}ms`, 'info');
+    }
+    
     exportCSV() {
         if (this.testResults.length === 0) {
             this.log('エクスポートするデータがありません', 'error');
             return;
         }
         
-        const headers = ['Sequence', 'Deviation_ms', 'Within_Tolerance', 'Expected_Time', 'Actual_Offset'];
+        // ESP32側の偏差 = クライアント送信ずれ + 伝送ずれ として分解
+        const clientDeviations = this.computeClientDeviations();
+        
+        const headers = ['Sequence', 'Deviation_ms', 'Within_Tolerance', 'Expected_Time', 'Actual_Offset',
+                         'Client_Intended_ms', 'Client_Actual_ms', 'Client_Deviation_ms', 'Transport_Deviation_ms'];
         const csvContent = [
             headers.join(','),
-            ...this.testResults.map((result, index) => [
-                result.sequence + 1,
-                result.deviation.toFixed(3),
-                result.withinTolerance ? 'YES' : 'NO',
-                (index * this.periodicSettings.period).toFixed(0), // 期待タイミング
-                ((index * this.periodicSettings.period) + result.deviation).toFixed(3) // 実際のオフセット
-            ].join(','))
+            ...this.testResults.map((result, index) => {
+                const client = clientDeviations[index];
+                return [
+                    result.sequence + 1,
+                    result.deviation.toFixed(3),
+                    result.withinTolerance ? 'YES' : 'NO',
+                    (index * this.periodicSettings.period).toFixed(0), // 期待タイミング
+                    ((index * this.periodicSettings.period) + result.deviation).toFixed(3), // 実際のオフセット
+                    client ? client.intendedTime.toFixed(3) : '',
+                    client ? client.actualTime.toFixed(3) : '',
+                    client ? client.clientDeviation.toFixed(3) : '',
+                    client ? (result.deviation - client.clientDeviation).toFixed(3) : ''
+                ].join(',');
+            })
         ].join('\n');
         
         const blob = new Blob([csvContent], { type: 'text/csv' });
@@ -0,0 +1,56 @@
+// BLE信号送信用クロック Worker
+// 絶対時刻のデッドラインで tick を通知する（メインスレッドの描画で遅延しない）
+// 時刻は performance.timeOrigin + performance.now() の絶対ミリ秒で扱う
+const SPIN_MS = 2; // デッドライン直前はbusy-waitで精度を確保
+
+let schedule = null;
+let timer = null;
+
+function now() {
+    return performance.timeOrigin + performance.now();
+}
+
+function scheduleTick(sequence) {
+    if (!schedule) return;
+
+    if (sequence >= schedule.count) {
+        postMessage({ type: 'done' });
+        schedule = null;
+        return;
+    }
+
+    // 累積誤差を避けるため、毎回開始時刻から計算
+    const deadline = schedule.startTime + sequence * schedule.period;
+    const wait = deadline - now();
+
+    if (wait > SPIN_MS) {
+        timer = setTimeout(() => scheduleTick(sequence), wait - SPIN_MS);
+        return;
+    }
+
+    while (now() < deadline) {
+        // Worker内なのでUIを止めずにbusy-waitできる
+    }
+
+    postMessage({ type: 'tick', sequence: sequence, deadline: deadline, firedAt: now() });
+    scheduleTick(sequence + 1);
+}
+
+onmessage = (event) => {
+    const message = event.data;
+
+    if (message.type === 'start') {
+        schedule = {
+            startTime: message.startTime,
+            period: message.period,
+            count: message.count
+        };
+        scheduleTick(0);
+    } else if (message.type === 'stop') {
+        schedule = null;
+        if (timer) {
+            clearTimeout(timer);
+            timer = null;
+        }
+    }
+};
@@ -0,0 +1,87 @@
+// オーディオパルス生成 AudioWorklet
+// オーディオスレッド上でサンプル単位の絶対フレーム位置にパルスを配置する
+// (メインスレッドの描画やsetTimeoutの遅延に影響されない)
+class PulseGeneratorProcessor extends AudioWorkletProcessor {
+    constructor() {
+        super();
+        this.schedule = null;
+        this.lastReportedSequence = -1;
+        this.port.onmessage = (event) => this.onMessage(event.data);
+    }
+
+    onMessage(message) {
+        if (message.type === 'start') {
+            // 時刻はAudioContext時間(秒)で受け取り、フレーム位置に変換
+            this.schedule = {
+                startFrame: Math.round(message.startTime * sampleRate),
+                periodFrames: message.period * sampleRate,
+                durationFrames: Math.round(message.duration * sampleRate),
+                count: message.count,
+                frequency: message.frequency,
+                gain: message.gain
+            };
+            this.lastReportedSequence = -1;
+        } else if (message.type === 'stop') {
+            this.schedule = null;
+        }
+    }
+
+    // k番目のパルス開始フレーム（累積誤差が出ないよう毎回基準から計算）
+    pulseStartFrame(k) {
+        return this.schedule.startFrame + Math.round(k * this.schedule.periodFrames);
+    }
+
+    process(inputs, outputs) {
+        const output = outputs[0];
+        const schedule = this.schedule;
+        if (!schedule || output.length === 0) return true;
+
+        const channel = output[0];
+        for (let i = 0; i < channel.length; i++) {
+            const frame = currentFrame + i;
+            if (frame < schedule.startFrame) continue;
+
+            // 直近に開始したパルス（新しいパルスは前のパルスを打ち切る）
+            let k = Math.floor((frame - schedule.startFrame) / schedule.periodFrames);
+            if (k >= schedule.count) k = schedule.count - 1;
+            if (this.pulseStartFrame(k + 1) <= frame && k + 1 < schedule.count) k++;
+
+            const start = this.pulseStartFrame(k);
+            const offset = frame - start;
+            if (offset < 0 || offset >= schedule.durationFrames) continue;
+
+            if (k > this.lastReportedSequence) {
+                // 一度も描画されなかったパルス（startメッセージの到着遅れ等）は欠落として通知
+                for (let skipped = this.lastReportedSequence + 1; skipped < k; skipped++) {
+                    this.port.postMessage({ type: 'skipped', sequence: skipped });
+                }
+                this.lastReportedSequence = k;
+                // 実際に描画を開始したフレーム（予定フレームより遅れていればパルス途中から）
+                this.port.postMessage({ type: 'pulse', sequence: k, frame: frame, scheduledFrame: start });
+            }
+
+            // 矩形波 + 指数減衰（0.1 → 0.001）
+            const phase = (offset * schedule.frequency / sampleRate) % 1;
+            const envelope = schedule.gain * Math.pow(0.01, offset / schedule.durationFrames);
+            channel[i] = (phase < 0.5 ? 1 : -1) * envelope;
+        }
+
+        for (let c = 1; c < output.length; c++) {
+            output[c].set(channel);
+        }
+
+        // 最後のパルスが鳴り終わったら完了通知
+        const endFrame = this.pulseStartFrame(schedule.count - 1) + schedule.durationFrames;
+        if (currentFrame + channel.length >= endFrame) {
+            for (let skipped = this.lastReportedSequence + 1; skipped < schedule.count; skipped++) {
+                this.port.postMessage({ type: 'skipped', sequence: skipped });
+            }
+            this.port.postMessage({ type: 'done' });
+            this.schedule = null;
+        }
+
+        return true;
+    }
+}
+
+registerProcessor('pulse-generator', PulseGeneratorProcessor);
@@ -17,18 +17,60 @@
 #define MOTOR_PIN 26
 #define LED_PIN 2
 #define AUDIO_INPUT_PIN A0  // イヤホンジャック信号入力 (GPIO36)
+#define AUDIO_INPUT_PIN_2 A3     // 2ch目アナログ入力 (GPIO39, ADC1)
+#define DIGITAL_CAPTURE_PIN 35   // デジタル捕捉入力 (GPIO35, 入力専用)
+
+// マルチチャネル捕捉設定
+#define AUDIO_CHANNEL_COUNT 3
+
+// 起動設定 (platformio.ini の build_flags で上書き可能)
+#define WIFI_BOOT_SYNC      0  // setup()内でWiFi AP/HTTPを起動 (従来動作)
+#define WIFI_BOOT_ASYNC     1  // 別タスクでWiFi AP/HTTPを起動
+#define WIFI_BOOT_ON_DEMAND 2  // CMD_WIFI_STARTを受けてから起動
+#define WIFI_BOOT_DISABLED  3  // WiFi AP/HTTPを起動しない
+
+#ifndef WIFI_BOOT_MODE
+#define WIFI_BOOT_MODE WIFI_BOOT_SYNC
+#endif
+#ifndef BOOT_BLE_FIRST
+#define BOOT_BLE_FIRST 0       // 1: WiFiより先にBLEアドバタイジングを開始
+#endif
+#ifndef ENABLE_BLE
+#define ENABLE_BLE 1
+#endif
+#ifndef ENABLE_AUDIO_INPUT
+#define ENABLE_AUDIO_INPUT 1
+#endif
+
+#if !ENABLE_BLE && WIFI_BOOT_MODE == WIFI_BOOT_ON_DEMAND
+#error "WIFI_BOOT_ON_DEMAND requires ENABLE_BLE (CMD_WIFI_START is received over BLE)"
+#endif
 
 // オーディオ信号検出設定
-#define AUDIO_THRESHOLD_HIGH 2500  // 信号HIGH検出閾値 (12bit ADC: 0-4095)
-#define AUDIO_THRESHOLD_LOW 1500   // 信号LOW検出閾値
 #define AUDIO_DEBOUNCE_MS 5        // ノイズ除去のためのデバウンス時間
 
+// オーディオ前段処理 (適応閾値) 設定
+// 内部値はADCカウントを AUDIO_FP_SHIFT ビット左シフトした固定小数点で保持する
+#define AUDIO_FP_SHIFT          8   // 固定小数点の小数部ビット数
+#define AUDIO_DC_SHIFT          10  // DCブロッカー時定数 (約2^10サンプル)
+#define AUDIO_ENV_ATTACK_SHIFT  1   // 包絡線の立ち上がり (速い)
+#define AUDIO_ENV_RELEASE_SHIFT 5   // 包絡線の減衰
+#define AUDIO_NOISE_FALL_SHIFT  4   // ノイズフロアの下降追従
+#define AUDIO_NOISE_RISE_SHIFT  12  // ノイズフロアの上昇追従 (信号で持ち上がらないよう遅く)
+#define AUDIO_PEAK_DECAY_SHIFT  8   // ピーク値の減衰 (約2^8サンプル ≒ 数パルス周期で音量低下に追従)
+#define AUDIO_MIN_HYSTERESIS    40  // ノイズフロアからの最小閾値マージン (ADCカウント)
+#define AUDIO_CALIBRATION_MS    500 // キャリブレーション (ノイズフロア学習) 時間
+
 // プロトコル定義
 #define CMD_TIME_SYNC           0x01
 #define CMD_MOTOR_CMD           0x02
 #define CMD_PERIODIC_TEST_START 0x03
 #define CMD_PERIODIC_SIGNAL     0x04
 #define CMD_GET_RESULTS         0x05
+#define CMD_AUDIO_CALIBRATE     0x06
+#define CMD_GET_AUDIO_RESULTS   0x07
+#define CMD_AUDIO_CHANNEL_CONFIG 0x08
+#define CMD_WIFI_START          0x09
 
 // 75ms周期測定用設定
 #define MAX_PERIODIC_SAMPLES 1000
@@ -49,6 +91,14 @@ IPAddress wifi_ip(192, 168, 4, 1);
 IPAddress wifi_gateway(192, 168, 4, 1);
 IPAddress wifi_subnet(255, 255, 255, 0);
 
+// WiFi起動状態 (非同期起動タスクから更新される)
+enum WiFiBootState : uint8_t {
+    WIFI_STATE_OFF = 0,
+    WIFI_STATE_STARTING = 1,
+    WIFI_STATE_READY = 2
+};
+volatile WiFiBootState wifiState = WIFI_STATE_OFF;
+
 // タイマー関連
 esp_timer_handle_t precisionTimer = nullptr;
 bool motorPending = false;
@@ -62,6 +112,71 @@ struct TimeSync {
     int64_t last_sync_time = 0;
 } timeSync;
 
+// 起動フェーズ計測用 (時刻はesp_timer_get_time()のリセットからのμs)
+#define MAX_BOOT_PHASES 8
+
+struct BootPhase {
+    const char* name;
+    int64_t start_us;
+    int64_t duration_us;
+};
+
+// 非同期/オンデマンド起動のWiFiタスクとBLEタスクからも更新されるため排他する
+portMUX_TYPE bootProfilerMux = portMUX_INITIALIZER_UNLOCKED;
+
+struct BootProfiler {
+    BootPhase phases[MAX_BOOT_PHASES];
+    uint8_t phase_count = 0;
+    int64_t setup_start_us = 0;
+    int64_t setup_end_us = 0;
+    int64_t ble_ready_us = -1;      // BLEアドバタイジング開始
+    int64_t http_ready_us = -1;     // HTTPサーバー受付開始
+    int64_t first_command_us = -1;  // 最初にコマンドを受け付けた時刻
+    
+    // フェーズ開始を記録し、end()に渡すインデックスを返す
+    int begin(const char* name) {
+        int index = -1;
+        portENTER_CRITICAL(&bootProfilerMux);
+        if (phase_count < MAX_BOOT_PHASES) {
+            index = phase_count++;
+            phases[index].name = name;
+            phases[index].start_us = esp_timer_get_time();
+            phases[index].duration_us = -1;
+        }
+        portEXIT_CRITICAL(&bootProfilerMux);
+        return index;
+    }
+    
+    void end(int index) {
+        if (index < 0) return;
+        portENTER_CRITICAL(&bootProfilerMux);
+        phases[index].duration_us = esp_timer_get_time() - phases[index].start_us;
+        portEXIT_CRITICAL(&bootProfilerMux);
+    }
+    
+    void mark(int64_t& field) {
+        portENTER_CRITICAL(&bootProfilerMux);
+        field = esp_timer_get_time();
+        portEXIT_CRITICAL(&bootProfilerMux);
+    }
+    
+    void markFirstCommand() {
+        portENTER_CRITICAL(&bootProfilerMux);
+        if (first_command_us < 0) {
+            first_command_us = esp_timer_get_time();
+        }
+        portEXIT_CRITICAL(&bootProfilerMux);
+    }
+    
+    // 表示用に一貫したコピーを取得
+    BootProfiler snapshot() const {
+        portENTER_CRITICAL(&bootProfilerMux);
+        BootProfiler copy = *this;
+        portEXIT_CRITICAL(&bootProfilerMux);
+        return copy;
+    }
+} bootProfiler;
+
 // 統計用
 struct TimingStats {
     uint32_t total_commands = 0;
@@ -78,6 +193,11 @@ struct AudioSignalDetector {
     uint32_t signal_count = 0;
     uint32_t first_signal_time = 0;
     bool monitoring_enabled = true;
+    uint16_t expected_period = EXPECTED_PERIOD_MS;
+    
+    // 統計
+    int16_t max_abs_deviation = 0;
+    uint32_t total_abs_deviation = 0;
     
     // 実際の測定データ保存用
     uint32_t timestamps[MAX_PERIODIC_SAMPLES];
@@ -88,13 +208,140 @@ struct AudioSignalDetector {
         first_signal_time = 0;
         is_signal_high = false;
         last_transition_time = 0;
+        max_abs_deviation = 0;
+        total_abs_deviation = 0;
         memset(timestamps, 0, sizeof(timestamps));
         memset(deviations, 0, sizeof(deviations));
     }
     
     void enable() { monitoring_enabled = true; }
     void disable() { monitoring_enabled = false; }
-} audioDetector;
+    
+    // 基準信号を除いた平均絶対偏差 (ms)
+    float meanAbsDeviation() const {
+        return signal_count > 1 ? (float)total_abs_deviation / (signal_count - 1) : 0.0f;
+    }
+};
+
+// オーディオ前段処理: DC除去 → 包絡線検出 → ノイズフロア推定 → 自動ヒステリシス閾値
+// 1サンプルあたり整数の加減算とシフトのみで処理する
+struct AudioFrontEnd {
+    bool primed = false;
+    int32_t dc_fp = 0;        // DC成分推定値
+    int32_t envelope_fp = 0;  // 包絡線 (DC除去後の絶対値)
+    int32_t noise_fp = 0;     // ノイズフロア
+    int32_t peak_fp = 0;      // 信号ピーク
+    int32_t threshold_high_fp = AUDIO_MIN_HYSTERESIS << AUDIO_FP_SHIFT;
+    int32_t threshold_low_fp = (AUDIO_MIN_HYSTERESIS / 2) << AUDIO_FP_SHIFT;
+    bool calibrating = false;
+    uint32_t calibration_end_time = 0;
+    volatile bool calibration_requested = false;  // BLE/HTTPからの再キャリブレーション要求
+    
+    void reset() {
+        primed = false;
+        dc_fp = 0;
+        envelope_fp = 0;
+        noise_fp = 0;
+        peak_fp = 0;
+        updateThresholds();
+    }
+    
+    void startCalibration(uint32_t now) {
+        reset();
+        calibrating = true;
+        calibration_end_time = now + AUDIO_CALIBRATION_MS;
+    }
+    
+    // 他タスクからはフラグのみ立て、実際のリセットはloop()側のprocess前に行う
+    void requestCalibration() { calibration_requested = true; }
+    bool isCalibrating() const { return calibrating || calibration_requested; }
+    
+    // 1サンプル処理し、包絡線値 (固定小数点) を返す
+    int32_t process(int raw) {
+        int32_t x_fp = (int32_t)raw << AUDIO_FP_SHIFT;
+        if (!primed) {
+            dc_fp = x_fp;
+            primed = true;
+        }
+        
+        // DCブロッカー (1次IIRでDC成分を追従して差し引く)
+        dc_fp += (x_fp - dc_fp) >> AUDIO_DC_SHIFT;
+        int32_t ac_fp = x_fp - dc_fp;
+        if (ac_fp < 0) ac_fp = -ac_fp;
+        
+        // 包絡線 (速いアタック、遅いリリース)
+        int shift = (ac_fp > envelope_fp) ? AUDIO_ENV_ATTACK_SHIFT : AUDIO_ENV_RELEASE_SHIFT;
+        envelope_fp += (ac_fp - envelope_fp) >> shift;
+        
+        // ノイズフロア (キャリブレーション中は両方向とも速く追従)
+        if (envelope_fp < noise_fp || calibrating) {
+            noise_fp += (envelope_fp - noise_fp) >> AUDIO_NOISE_FALL_SHIFT;
+        } else {
+            noise_fp += (envelope_fp - noise_fp) >> AUDIO_NOISE_RISE_SHIFT;
+        }
+        
+        // ピーク (即時追従、ノイズフロアに向けて緩やかに減衰)
+        if (calibrating) {
+            peak_fp = noise_fp;
+        } else if (envelope_fp > peak_fp) {
+            peak_fp = envelope_fp;
+        } else {
+            peak_fp -= (peak_fp - noise_fp) >> AUDIO_PEAK_DECAY_SHIFT;
+        }
+        
+        updateThresholds();
+        return envelope_fp;
+    }
+    
+    // ピークとノイズフロアの間にヒステリシス閾値を配置 (HIGH: 1/2, LOW: 1/4)
+    void updateThresholds() {
+        int32_t span_fp = peak_fp - noise_fp;
+        int32_t min_fp = AUDIO_MIN_HYSTERESIS << AUDIO_FP_SHIFT;
+        if (span_fp < min_fp * 2) {
+            span_fp = min_fp * 2;
+        }
+        threshold_high_fp = noise_fp + (span_fp >> 1);
+        threshold_low_fp = noise_fp + (span_fp >> 2);
+    }
+    
+    int dcLevel() const { return dc_fp >> AUDIO_FP_SHIFT; }
+    int envelopeLevel() const { return envelope_fp >> AUDIO_FP_SHIFT; }
+    int noiseFloor() const { return noise_fp >> AUDIO_FP_SHIFT; }
+    int peakLevel() const { return peak_fp >> AUDIO_FP_SHIFT; }
+    int thresholdHigh() const { return threshold_high_fp >> AUDIO_FP_SHIFT; }
+    int thresholdLow() const { return threshold_low_fp >> AUDIO_FP_SHIFT; }
+};
+
+// 捕捉チャネル定義 (ADC1アナログ入力 または デジタル入力)
+struct AudioChannelConfig {
+    uint8_t pin;
+    bool is_digital;
+    bool enabled;       // 起動時にスキャン対象とするか
+};
+
+const AudioChannelConfig audioChannelConfigs[AUDIO_CHANNEL_COUNT] = {
+    { AUDIO_INPUT_PIN,     false, true  },
+    { AUDIO_INPUT_PIN_2,   false, false },
+    { DIGITAL_CAPTURE_PIN, true,  false },
+};
+
+// BLEタスクとloop()の間で設定変更要求 (pending_*) を受け渡すため排他する
+portMUX_TYPE audioConfigMux = portMUX_INITIALIZER_UNLOCKED;
+
+// チャネルごとの検出器・前段処理・バッファ
+// 全チャネルは1回のスキャンで続けてサンプリングし、共通のタイムスタンプを使う
+struct AudioChannel {
+    uint8_t pin = 0;
+    bool is_digital = false;
+    bool enabled = false;
+    AudioFrontEnd frontEnd;
+    AudioSignalDetector detector;
+    
+    // BLEタスクからの設定変更要求 (loop()側で適用、audioConfigMuxで保護)
+    bool config_pending = false;
+    bool pending_enabled = false;
+    uint16_t pending_period = 0;
+} audioChannels[AUDIO_CHANNEL_COUNT];
 
 // 75ms周期測定用
 struct PeriodicTest {
@@ -129,20 +376,36 @@ void setupWiFiAP();
 void setupHTTPServer();
 void setupWiFiTime();
 void setupAudioInput();
+void startBLE();
+void startNetwork();
+void requestWiFiStart();
+void bringUpWiFi();
+void wifiStartTask(void* arg);
+void printBootProfile();
 int64_t getCurrentTimeMs();
 void handleTimeSync(uint8_t* data, size_t length);
 void handleMotorCommand(uint8_t* data, size_t length);
 void handlePeriodicTestStart(uint8_t* data, size_t length);
 void handlePeriodicSignal(uint8_t* data, size_t length);
 void handleGetResults(uint8_t* data, size_t length);
+void handleAudioCalibrate(uint8_t* data, size_t length);
+void handleGetAudioResults(uint8_t* data, size_t length);
+void handleAudioChannelConfig(uint8_t* data, size_t length);
+void handleWiFiStart(uint8_t* data, size_t length);
 void sendResponse(uint8_t command, uint8_t* data, size_t length);
 void executeMotorControl();
 void IRAM_ATTR timerCallback(void* arg);
 void updateStatistics(float error);
 void checkAudioInput();
-void onAudioSignalDetected(uint32_t timestamp);
+void processAudioChannel(uint8_t channel, int sample, uint32_t timestamp);
+void applyAudioChannelConfig(uint8_t channel, bool enabled, uint16_t period, uint32_t now);
+void onAudioSignalDetected(uint8_t channel, uint32_t timestamp);
 void handleHTTPCORS();
 void handleAudioResults();
+void handleAudioCalibration();
+void handleAudioChannels();
+void handleBootProfile();
+int getRequestedAudioChannel();
 
 // BLEコールバック
 class MyServerCallbacks: public BLEServerCallbacks {
@@ -175,6 +438,7 @@ class CommandCallbacks: public BLECharacteristicCallbacks {
         if (length > 0 && data != nullptr) {
             uint8_t command = data[0];
             
+            // 最初のコマンド時刻は各ハンドラーがパケットを受理した時点で記録する
             switch (command) {
                 case CMD_TIME_SYNC:
                     handleTimeSync(data, length);
@@ -191,6 +455,18 @@ class CommandCallbacks: public BLECharacteristicCallbacks {
                 case CMD_GET_RESULTS:
                     handleGetResults(data, length);
                     break;
+                case CMD_AUDIO_CALIBRATE:
+                    handleAudioCalibrate(data, length);
+                    break;
+                case CMD_GET_AUDIO_RESULTS:
+                    handleGetAudioResults(data, length);
+                    break;
+                case CMD_AUDIO_CHANNEL_CONFIG:
+                    handleAudioChannelConfig(data, length);
+                    break;
+                case CMD_WIFI_START:
+                    handleWiFiStart(data, length);
+                    break;
                 default:
                     Serial.printf("Unknown command: 0x%02X\n", command);
                     break;
@@ -200,6 +476,8 @@ class CommandCallbacks: public BLECharacteristicCallbacks {
 };
 
 void setup() {
+    bootProfiler.mark(bootProfiler.setup_start_us);
+    
     Serial.begin(115200);
     Serial.println("ESP32 BLE Timing Tester Starting...");
     
@@ -209,37 +487,62 @@ void setup() {
     digitalWrite(MOTOR_PIN, LOW);
     digitalWrite(LED_PIN, LOW);
     
+#if ENABLE_AUDIO_INPUT
     // オーディオ入力初期化
+    int phase = bootProfiler.begin("audio_input");
     setupAudioInput();
+    bootProfiler.end(phase);
+#endif
     
     // 高精度タイマー初期化
+    int timerPhase = bootProfiler.begin("precision_timer");
     const esp_timer_create_args_t timerArgs = {
         .callback = &timerCallback,
         .name = "precision_timer"
     };
     esp_timer_create(&timerArgs, &precisionTimer);
-    
-    // WiFi時刻同期
-    setupWiFiTime();
-    
-    // WiFi AP初期化
-    setupWiFiAP();
-    
-    // HTTP Server初期化
-    setupHTTPServer();
-    
-    // BLE初期化
-    setupBLE();
-    
+    bootProfiler.end(timerPhase);
+    
+#if BOOT_BLE_FIRST || WIFI_BOOT_MODE != WIFI_BOOT_SYNC
+    // BLEを先に起動し、コマンド受付までの時間を短縮
+    // (非同期起動のWiFiタスクはBLE初期化完了後に開始し、無線スタックの同時初期化を避ける)
+    startBLE();
+    startNetwork();
+#else
+    startNetwork();
+    startBLE();
+#endif
+    
+    bootProfiler.mark(bootProfiler.setup_end_us);
+    printBootProfile();
+    
+#if ENABLE_BLE
     Serial.println("Setup complete. Waiting for BLE connection...");
+#else
+    Serial.println("Setup complete.");
+#endif
 }
 
 void loop() {
     // HTTP server処理
-    httpServer.handleClient();
+    if (wifiState == WIFI_STATE_READY) {
+        httpServer.handleClient();
+    }
     
+#if ENABLE_AUDIO_INPUT
     // オーディオ信号検出
     checkAudioInput();
+#endif
+    
+    // リセットから最初のコマンド受付までの時間を一度だけ表示
+    static bool firstCommandReported = false;
+    if (!firstCommandReported) {
+        int64_t firstCommandUs = bootProfiler.snapshot().first_command_us;
+        if (firstCommandUs >= 0) {
+            Serial.printf("First command accepted at %lld us after reset\n", firstCommandUs);
+            firstCommandReported = true;
+        }
+    }
     
     // 接続状態監視
     static unsigned long lastCheck = 0;
@@ -251,15 +554,108 @@ void loop() {
                 Serial.println("Periodic test in progress...");
             }
         }
-        if (audioDetector.signal_count > 0) {
-            Serial.printf("Audio signals detected: %d\n", audioDetector.signal_count);
+#if ENABLE_AUDIO_INPUT
+        for (uint8_t ch = 0; ch < AUDIO_CHANNEL_COUNT; ch++) {
+            AudioChannel& channel = audioChannels[ch];
+            if (!channel.enabled) continue;
+            if (channel.detector.signal_count > 0) {
+                Serial.printf("Audio ch%d signals detected: %d (mean |dev| %.2fms, max %dms)\n", ch,
+                             channel.detector.signal_count, channel.detector.meanAbsDeviation(),
+                             channel.detector.max_abs_deviation);
+            }
+            if (!channel.is_digital) {
+                Serial.printf("Audio ch%d front-end: noise=%d, peak=%d, thresholds=%d/%d\n", ch,
+                             channel.frontEnd.noiseFloor(), channel.frontEnd.peakLevel(),
+                             channel.frontEnd.thresholdHigh(), channel.frontEnd.thresholdLow());
+            }
+        }
+#endif
+        if (wifiState == WIFI_STATE_READY) {
+            Serial.printf("WiFi AP: %s, IP: %s\n", wifi_ssid, WiFi.softAPIP().toString().c_str());
         }
-        Serial.printf("WiFi AP: %s, IP: %s\n", wifi_ssid, WiFi.softAPIP().toString().c_str());
         lastCheck = millis();
     }
     delay(1); // オーディオ監視のため短い遅延
 }
 
+void startBLE() {
+#if ENABLE_BLE
+    int phase = bootProfiler.begin("ble");
+    setupBLE();
+    bootProfiler.end(phase);
+    bootProfiler.mark(bootProfiler.ble_ready_us);
+#else
+    Serial.println("BLE disabled by configuration");
+#endif
+}
+
+void startNetwork() {
+#if WIFI_BOOT_MODE == WIFI_BOOT_SYNC
+    bringUpWiFi();
+#elif WIFI_BOOT_MODE == WIFI_BOOT_ASYNC
+    requestWiFiStart();
+#elif WIFI_BOOT_MODE == WIFI_BOOT_ON_DEMAND
+    Serial.println("WiFi AP deferred: send CMD_WIFI_START (0x09) to start");
+#else
+    Serial.println("WiFi AP disabled by configuration");
+#endif
+}
+
+// WiFi時刻同期 → WiFi AP → HTTPサーバーの順に起動
+void bringUpWiFi() {
+    wifiState = WIFI_STATE_STARTING;
+    
+    int phase = bootProfiler.begin("wifi_time");
+    setupWiFiTime();
+    bootProfiler.end(phase);
+    
+    phase = bootProfiler.begin("wifi_ap");
+    setupWiFiAP();
+    bootProfiler.end(phase);
+    
+    phase = bootProfiler.begin("http_server");
+    setupHTTPServer();
+    bootProfiler.end(phase);
+    
+    bootProfiler.mark(bootProfiler.http_ready_us);
+    wifiState = WIFI_STATE_READY;
+}
+
+// 別タスクでWiFiを起動 (setup()/BLEをブロックしない)
+void requestWiFiStart() {
+#if WIFI_BOOT_MODE != WIFI_BOOT_DISABLED
+    if (wifiState != WIFI_STATE_OFF) return;
+    wifiState = WIFI_STATE_STARTING;
+    
+    if (xTaskCreate(wifiStartTask, "wifi_start", 8192, nullptr, 1, nullptr) != pdPASS) {
+        Serial.println("Failed to create WiFi start task");
+        wifiState = WIFI_STATE_OFF;
+    }
+#endif
+}
+
+void wifiStartTask(void* arg) {
+    bringUpWiFi();
+    Serial.println("WiFi AP started asynchronously");
+    printBootProfile();
+    vTaskDelete(nullptr);
+}
+
+void printBootProfile() {
+    BootProfiler profile = bootProfiler.snapshot();
+    
+    Serial.println("Boot profile:");
+    for (uint8_t i = 0; i < profile.phase_count; i++) {
+        const BootPhase& phase = profile.phases[i];
+        Serial.printf("  %-16s start: %8lld us, duration: %8lld us\n",
+                      phase.name, phase.start_us, phase.duration_us);
+    }
+    Serial.printf("  setup():         %lld us\n", profile.setup_end_us - profile.setup_start_us);
+    Serial.printf("  BLE ready at:    %lld us\n", profile.ble_ready_us);
+    Serial.printf("  HTTP ready at:   %lld us\n", profile.http_ready_us);
+    Serial.printf("  First command:   %lld us\n", profile.first_command_us);
+}
+
 void setupWiFiTime() {
     // 簡易時刻初期化
     Serial.println("Time initialized");
@@ -314,6 +710,7 @@ void handleTimeSync(uint8_t* data, size_t length) {
         Serial.println("Invalid time sync packet");
         return;
     }
+    bootProfiler.markFirstCommand();
     
     // t1 (送信時刻)を取得
     int64_t t1 = 0;
@@ -350,6 +747,7 @@ void handleMotorCommand(uint8_t* data, size_t length) {
         Serial.println("Invalid motor command packet");
         return;
     }
+    bootProfiler.markFirstCommand();
     
     uint8_t motorCmd = data[1];
     int64_t sentAt, executeAt;
@@ -456,6 +854,7 @@ void handlePeriodicTestStart(uint8_t* data, size_t length) {
         Serial.println("Invalid periodic test start packet");
         return;
     }
+    bootProfiler.markFirstCommand();
     
     uint16_t count, period;
     memcpy(&count, data + 1, 2);
@@ -496,6 +895,7 @@ void handlePeriodicSignal(uint8_t* data, size_t length) {
         Serial.println("Periodic test sample limit reached");
         return;
     }
+    bootProfiler.markFirstCommand();
     
     uint32_t receivedAt = millis();
     
@@ -533,6 +933,8 @@ void handlePeriodicSignal(uint8_t* data, size_t length) {
 }
 
 void handleGetResults(uint8_t* data, size_t length) {
+    bootProfiler.markFirstCommand();
+    
     if (periodicTest.sample_count == 0) {
         Serial.println("No periodic test results available");
         
@@ -612,69 +1014,317 @@ void handleGetResults(uint8_t* data, size_t length) {
 }
 
 void setupAudioInput() {
-    // ADC1の初期化（GPIO36 = A0）
+    // ADC1の初期化（GPIO36 = A0, GPIO39 = A3）
     analogReadResolution(12); // 12bit分解能 (0-4095)
     
-    // オーディオ検出器初期化
-    audioDetector.reset();
+    uint32_t now = millis();
+    for (uint8_t ch = 0; ch < AUDIO_CHANNEL_COUNT; ch++) {
+        AudioChannel& channel = audioChannels[ch];
+        channel.pin = audioChannelConfigs[ch].pin;
+        channel.is_digital = audioChannelConfigs[ch].is_digital;
+        channel.enabled = audioChannelConfigs[ch].enabled;
+        
+        if (channel.is_digital) {
+            pinMode(channel.pin, INPUT);
+        }
+        
+        // オーディオ検出器初期化
+        channel.detector.reset();
+        
+        // 前段処理の初期キャリブレーション（ノイズフロア学習）
+        channel.frontEnd.startCalibration(now);
+        
+        Serial.printf("Audio ch%d: GPIO%d (%s)%s\n", ch, channel.pin,
+                      channel.is_digital ? "digital" : "analog",
+                      channel.enabled ? "" : " disabled");
+    }
     
-    Serial.println("Audio input initialized on GPIO36 (A0)");
-    Serial.printf("Signal thresholds: HIGH > %d, LOW < %d\n", 
-                  AUDIO_THRESHOLD_HIGH, AUDIO_THRESHOLD_LOW);
+    Serial.printf("Adaptive thresholds: calibrating for %d ms (min hysteresis %d)\n",
+                  AUDIO_CALIBRATION_MS, AUDIO_MIN_HYSTERESIS);
 }
 
 void checkAudioInput() {
-    if (!audioDetector.monitoring_enabled) return;
-    
     uint32_t currentTime = millis();
-    int adcValue = analogRead(AUDIO_INPUT_PIN);
     
-    // 信号レベル判定
-    bool signalHigh = (adcValue > AUDIO_THRESHOLD_HIGH);
-    bool signalLow = (adcValue < AUDIO_THRESHOLD_LOW);
+    // BLEからの設定変更はスキャン開始前にここで適用する
+    for (uint8_t ch = 0; ch < AUDIO_CHANNEL_COUNT; ch++) {
+        AudioChannel& channel = audioChannels[ch];
+        
+        // 要求は同じ排他区間で取り出してクリアする (取り出し後に届いた要求は次のスキャンで適用)
+        portENTER_CRITICAL(&audioConfigMux);
+        bool pending = channel.config_pending;
+        bool pending_enabled = channel.pending_enabled;
+        uint16_t pending_period = channel.pending_period;
+        channel.config_pending = false;
+        portEXIT_CRITICAL(&audioConfigMux);
+        
+        if (pending) {
+            applyAudioChannelConfig(ch, pending_enabled, pending_period, currentTime);
+        }
+    }
+    
+    // 有効な全チャネルを続けてサンプリングし、同じ時刻として扱う
+    bool enabled[AUDIO_CHANNEL_COUNT];
+    int samples[AUDIO_CHANNEL_COUNT] = {0};
+    for (uint8_t ch = 0; ch < AUDIO_CHANNEL_COUNT; ch++) {
+        const AudioChannel& channel = audioChannels[ch];
+        enabled[ch] = channel.enabled;
+        if (!enabled[ch]) continue;
+        samples[ch] = channel.is_digital ? digitalRead(channel.pin) : analogRead(channel.pin);
+    }
+    
+    for (uint8_t ch = 0; ch < AUDIO_CHANNEL_COUNT; ch++) {
+        if (!enabled[ch]) continue;
+        processAudioChannel(ch, samples[ch], currentTime);
+    }
+}
+
+// チャネル設定を適用し検出器をリセット (loop()タスクからのみ呼ぶ)
+void applyAudioChannelConfig(uint8_t ch, bool enabled, uint16_t period, uint32_t now) {
+    AudioChannel& channel = audioChannels[ch];
+    
+    bool wasEnabled = channel.enabled;
+    channel.enabled = enabled;
+    if (period > 0) {
+        channel.detector.expected_period = period;
+    }
+    channel.detector.reset();
+    if (channel.enabled && !wasEnabled) {
+        channel.frontEnd.startCalibration(now);
+    }
+    
+    Serial.printf("Audio ch%d configured: %s, %dms period\n", ch,
+                  channel.enabled ? "enabled" : "disabled", channel.detector.expected_period);
+}
+
+void processAudioChannel(uint8_t ch, int sample, uint32_t currentTime) {
+    AudioChannel& channel = audioChannels[ch];
+    AudioFrontEnd& frontEnd = channel.frontEnd;
+    AudioSignalDetector& detector = channel.detector;
+    
+    bool signalHigh;
+    bool signalLow;
+    
+    if (channel.is_digital) {
+        signalHigh = (sample == HIGH);
+        signalLow = !signalHigh;
+    } else {
+        if (frontEnd.calibration_requested) {
+            frontEnd.calibration_requested = false;
+            frontEnd.startCalibration(currentTime);
+            detector.is_signal_high = false;
+        }
+        
+        // 前段処理は監視停止中も回し続け、DC/ノイズ推定を最新に保つ
+        int32_t envelope = frontEnd.process(sample);
+        
+        if (frontEnd.calibrating) {
+            if ((int32_t)(currentTime - frontEnd.calibration_end_time) >= 0) {
+                frontEnd.calibrating = false;
+                Serial.printf("[AUDIO ch%d] Calibration done. DC: %d, noise: %d, thresholds: HIGH > %d, LOW < %d\n",
+                              ch, frontEnd.dcLevel(), frontEnd.noiseFloor(),
+                              frontEnd.thresholdHigh(), frontEnd.thresholdLow());
+            }
+            return;
+        }
+        
+        // 信号レベル判定（包絡線と適応閾値で比較）
+        signalHigh = (envelope > frontEnd.threshold_high_fp);
+        signalLow = (envelope < frontEnd.threshold_low_fp);
+    }
+    
+    if (!detector.monitoring_enabled) return;
     
     // 状態変化検出（LOWからHIGHへの立ち上がりエッジ）
-    if (!audioDetector.is_signal_high && signalHigh) {
+    if (!detector.is_signal_high && signalHigh) {
         // デバウンス処理
-        if (currentTime - audioDetector.last_transition_time >= AUDIO_DEBOUNCE_MS) {
-            audioDetector.is_signal_high = true;
-            audioDetector.last_transition_time = currentTime;
-            onAudioSignalDetected(currentTime);
+        if (currentTime - detector.last_transition_time >= AUDIO_DEBOUNCE_MS) {
+            detector.is_signal_high = true;
+            detector.last_transition_time = currentTime;
+            onAudioSignalDetected(ch, currentTime);
         }
-    } else if (audioDetector.is_signal_high && signalLow) {
+    } else if (detector.is_signal_high && signalLow) {
         // HIGH→LOW遷移
-        if (currentTime - audioDetector.last_transition_time >= AUDIO_DEBOUNCE_MS) {
-            audioDetector.is_signal_high = false;
-            audioDetector.last_transition_time = currentTime;
+        if (currentTime - detector.last_transition_time >= AUDIO_DEBOUNCE_MS) {
+            detector.is_signal_high = false;
+            detector.last_transition_time = currentTime;
+        }
+    }
+}
+
+void handleAudioCalibrate(uint8_t* data, size_t length) {
+    // [0x06][restart:1 (省略可)][ch:1 (省略可)] restart=1 でキャリブレーションをやり直す
+    uint8_t ch = (length >= 3) ? data[2] : 0;
+    if (ch >= AUDIO_CHANNEL_COUNT || audioChannels[ch].is_digital) {
+        Serial.printf("Invalid audio calibration channel: %d\n", ch);
+        return;
+    }
+    bootProfiler.markFirstCommand();
+    
+    AudioChannel& channel = audioChannels[ch];
+    
+    if (length >= 2 && data[1] != 0) {
+        channel.frontEnd.requestCalibration();
+        Serial.printf("Audio ch%d calibration restarted\n", ch);
+    }
+    
+    // 応答: [0x06][DC:2][ノイズ:2][ピーク:2][HIGH閾値:2][LOW閾値:2][キャリブレーション中:1][ch:1]
+    uint16_t levels[5] = {
+        (uint16_t)channel.frontEnd.dcLevel(),
+        (uint16_t)channel.frontEnd.noiseFloor(),
+        (uint16_t)channel.frontEnd.peakLevel(),
+        (uint16_t)channel.frontEnd.thresholdHigh(),
+        (uint16_t)channel.frontEnd.thresholdLow()
+    };
+    uint8_t response[13];
+    response[0] = CMD_AUDIO_CALIBRATE;
+    memcpy(response + 1, levels, sizeof(levels));
+    response[11] = channel.frontEnd.isCalibrating() ? 1 : 0;
+    response[12] = ch;
+    
+    sendResponse(CMD_AUDIO_CALIBRATE, response, sizeof(response));
+    
+    Serial.printf("Audio ch%d calibration: DC=%d, noise=%d, peak=%d, HIGH=%d, LOW=%d%s\n",
+                  ch, levels[0], levels[1], levels[2], levels[3], levels[4],
+                  channel.frontEnd.isCalibrating() ? " (calibrating)" : "");
+}
+
+void handleGetAudioResults(uint8_t* data, size_t length) {
+    // [0x07][ch:1]
+    if (length < 2 || data[1] >= AUDIO_CHANNEL_COUNT) {
+        Serial.println("Invalid audio results request");
+        return;
+    }
+    bootProfiler.markFirstCommand();
+    
+    uint8_t ch = data[1];
+    const AudioSignalDetector& detector = audioChannels[ch].detector;
+    
+    // 応答: [0x07][ch:1][count:2][最大|偏差|:2][平均|偏差|×100:2][最初の信号時刻:4][偏差:2 × count]
+    // (最初の信号時刻はチャネル間のずれ比較用のmillis()値、BLEの実用的な制限512バイトまで)
+    uint16_t result_count = detector.signal_count;
+    if (12 + result_count * 2 > 512) {
+        result_count = (512 - 12) / 2;
+    }
+    size_t response_size = 12 + result_count * 2;
+    
+    uint8_t* response = (uint8_t*)malloc(response_size);
+    if (!response) {
+        Serial.println("Failed to allocate response buffer");
+        return;
+    }
+    
+    response[0] = CMD_GET_AUDIO_RESULTS;
+    response[1] = ch;
+    memcpy(response + 2, &result_count, 2);
+    memcpy(response + 4, &detector.max_abs_deviation, 2);
+    uint16_t mean_abs_x100 = (uint16_t)(detector.meanAbsDeviation() * 100.0f + 0.5f);
+    memcpy(response + 6, &mean_abs_x100, 2);
+    memcpy(response + 8, &detector.first_signal_time, 4);
+    memcpy(response + 12, detector.deviations, result_count * 2);
+    
+    sendResponse(CMD_GET_AUDIO_RESULTS, response, response_size);
+    
+    Serial.printf("Audio ch%d results sent: %d samples\n", ch, result_count);
+    
+    free(response);
+}
+
+void handleAudioChannelConfig(uint8_t* data, size_t length) {
+    // [0x08][ch:1][enabled:1][period:2] 設定変更時は検出器をリセット
+    if (length < 2 || data[1] >= AUDIO_CHANNEL_COUNT) {
+        Serial.println("Invalid audio channel config packet");
+        return;
+    }
+    bootProfiler.markFirstCommand();
+    
+    uint8_t ch = data[1];
+    AudioChannel& channel = audioChannels[ch];
+    
+    // 検出器のバッファはloop()が書き込み中のため、変更はloop()側で適用する
+    bool enabled = channel.enabled;
+    uint16_t period = channel.detector.expected_period;
+    uint16_t count = channel.detector.signal_count;
+    if (length >= 5) {
+        uint16_t requested_period;
+        memcpy(&requested_period, data + 3, 2);
+        
+        enabled = (data[2] != 0);
+        if (requested_period > 0) {
+            period = requested_period;
         }
+        portENTER_CRITICAL(&audioConfigMux);
+        channel.pending_enabled = enabled;
+        channel.pending_period = period;
+        channel.config_pending = true;
+        portEXIT_CRITICAL(&audioConfigMux);
+        
+        // 適用時に検出器はリセットされる
+        count = 0;
     }
+    
+    // 応答: [0x08][ch:1][enabled:1][period:2][digital:1][pin:1][count:2] (設定変更時は適用後の値)
+    uint8_t response[9];
+    response[0] = CMD_AUDIO_CHANNEL_CONFIG;
+    response[1] = ch;
+    response[2] = enabled ? 1 : 0;
+    memcpy(response + 3, &period, 2);
+    response[5] = channel.is_digital ? 1 : 0;
+    response[6] = channel.pin;
+    memcpy(response + 7, &count, 2);
+    
+    sendResponse(CMD_AUDIO_CHANNEL_CONFIG, response, sizeof(response));
 }
 
-void onAudioSignalDetected(uint32_t timestamp) {
-    if (audioDetector.signal_count >= MAX_PERIODIC_SAMPLES) {
-        Serial.println("Audio detector buffer full");
+void handleWiFiStart(uint8_t* data, size_t length) {
+    // [0x09] WiFi AP/HTTPをオンデマンド起動
+    bootProfiler.markFirstCommand();
+    
+    requestWiFiStart();
+    
+    // 応答: [0x09][state:1] (0=OFF, 1=起動中, 2=準備完了)
+    uint8_t response[2];
+    response[0] = CMD_WIFI_START;
+    response[1] = wifiState;
+    
+    sendResponse(CMD_WIFI_START, response, sizeof(response));
+    
+    Serial.printf("WiFi start requested (state: %d)\n", wifiState);
+}
+
+void onAudioSignalDetected(uint8_t ch, uint32_t timestamp) {
+    AudioSignalDetector& detector = audioChannels[ch].detector;
+    
+    if (detector.signal_count >= MAX_PERIODIC_SAMPLES) {
+        Serial.printf("Audio ch%d detector buffer full\n", ch);
         return;
     }
     
     // タイムスタンプを保存
-    audioDetector.timestamps[audioDetector.signal_count] = timestamp;
+    detector.timestamps[detector.signal_count] = timestamp;
     
-    if (audioDetector.signal_count == 0) {
+    if (detector.signal_count == 0) {
         // 最初の信号を基準として記録
-        audioDetector.first_signal_time = timestamp;
-        audioDetector.deviations[0] = 0; // 基準は偏差0
-        Serial.printf("[AUDIO] Signal #1 detected at %u ms (baseline)\n", timestamp);
+        detector.first_signal_time = timestamp;
+        detector.deviations[0] = 0; // 基準は偏差0
+        Serial.printf("[AUDIO ch%d] Signal #1 detected at %u ms (baseline)\n", ch, timestamp);
     } else {
-        // 75ms周期からの偏差を計算（絶対時間基準）
-        uint32_t expected_time = audioDetector.first_signal_time + (audioDetector.signal_count * 75);
+        // 設定周期からの偏差を計算（絶対時間基準）
+        uint32_t expected_time = detector.first_signal_time + (detector.signal_count * detector.expected_period);
         int32_t deviation = (int32_t)(timestamp - expected_time);
-        audioDetector.deviations[audioDetector.signal_count] = (int16_t)deviation;
+        detector.deviations[detector.signal_count] = (int16_t)deviation;
+        
+        int16_t abs_dev = abs((int16_t)deviation);
+        detector.total_abs_deviation += abs_dev;
+        if (abs_dev > detector.max_abs_deviation) {
+            detector.max_abs_deviation = abs_dev;
+        }
         
-        Serial.printf("[AUDIO] Signal #%d detected at %u ms (expected: %u ms, deviation: %+d ms)\n", 
-                      audioDetector.signal_count + 1, timestamp, expected_time, deviation);
+        Serial.printf("[AUDIO ch%d] Signal #%d detected at %u ms (expected: %u ms, deviation: %+d ms)\n", 
+                      ch, detector.signal_count + 1, timestamp, expected_time, deviation);
     }
     
-    audioDetector.signal_count++;
+    detector.signal_count++;
 }
 
 void setupWiFiAP() {
@@ -704,13 +1354,24 @@ void setupHTTPServer() {
     // API エンドポイント
     httpServer.on("/api/audio-results", HTTP_GET, handleAudioResults);
     httpServer.on("/api/audio-results", HTTP_OPTIONS, handleHTTPCORS);
+    httpServer.on("/api/audio-calibration", HTTP_GET, handleAudioCalibration);
+    httpServer.on("/api/audio-calibration", HTTP_OPTIONS, handleHTTPCORS);
+    httpServer.on("/api/audio-channels", HTTP_GET, handleAudioChannels);
+    httpServer.on("/api/audio-channels", HTTP_OPTIONS, handleHTTPCORS);
+    httpServer.on("/api/boot-profile", HTTP_GET, handleBootProfile);
+    httpServer.on("/api/boot-profile", HTTP_OPTIONS, handleHTTPCORS);
     
     // ルートページ（テスト用）
     httpServer.on("/", []() {
         String html = "<html><body>";
         html += "<h1>ESP32 Timer - Audio Mode</h1>";
-        html += "<p>Audio signals detected: " + String(audioDetector.signal_count) + "</p>";
-        html += "<p>API endpoint: <a href='/api/audio-results'>/api/audio-results</a></p>";
+        for (uint8_t ch = 0; ch < AUDIO_CHANNEL_COUNT; ch++) {
+            if (!audioChannels[ch].enabled) continue;
+            html += "<p>Audio ch" + String(ch) + " signals detected: " +
+                    String(audioChannels[ch].detector.signal_count) + "</p>";
+        }
+        html += "<p>API endpoint: <a href='/api/audio-results'>/api/audio-results</a> (?ch=N)</p>";
+        html += "<p>Channels: <a href='/api/audio-channels'>/api/audio-channels</a></p>";
         html += "</body></html>";
         
         httpServer.send(200, "text/html", html);
@@ -727,29 +1388,171 @@ void handleHTTPCORS() {
     httpServer.send(200, "text/plain", "");
 }
 
+// ?ch=N で対象チャネルを取得 (省略時は0、不正な場合は-1)
+int getRequestedAudioChannel() {
+    if (!httpServer.hasArg("ch")) return 0;
+    int ch = httpServer.arg("ch").toInt();
+    if (ch < 0 || ch >= AUDIO_CHANNEL_COUNT) return -1;
+    return ch;
+}
+
 void handleAudioResults() {
+    bootProfiler.markFirstCommand();
+    
     // CORS headers
     httpServer.sendHeader("Access-Control-Allow-Origin", "*");
     httpServer.sendHeader("Access-Control-Allow-Methods", "GET, POST, OPTIONS");
     httpServer.sendHeader("Access-Control-Allow-Headers", "Content-Type");
     
+    int ch = getRequestedAudioChannel();
+    if (ch < 0) {
+        httpServer.send(400, "application/json", "{\"error\":\"invalid channel\"}");
+        return;
+    }
+    const AudioSignalDetector& detector = audioChannels[ch].detector;
+    
     // JSON レスポンス作成
     DynamicJsonDocument doc(2048);
     
-    doc["signal_count"] = audioDetector.signal_count;
-    doc["first_signal_time"] = audioDetector.first_signal_time;
-    doc["monitoring_enabled"] = audioDetector.monitoring_enabled;
+    doc["channel"] = ch;
+    doc["signal_count"] = detector.signal_count;
+    doc["first_signal_time"] = detector.first_signal_time;
+    doc["monitoring_enabled"] = detector.monitoring_enabled;
+    doc["expected_period"] = detector.expected_period;
+    doc["max_abs_deviation"] = detector.max_abs_deviation;
+    doc["mean_abs_deviation"] = detector.meanAbsDeviation();
     
     // 偏差データ配列
     JsonArray deviations = doc.createNestedArray("deviations");
     JsonArray timestamps = doc.createNestedArray("timestamps");
     
-    if (audioDetector.signal_count > 0) {
-        for (int i = 0; i < audioDetector.signal_count && i < 100; i++) {
+    if (detector.signal_count > 0) {
+        for (int i = 0; i < detector.signal_count && i < 100; i++) {
             // 実際の偏差データを使用
-            deviations.add(audioDetector.deviations[i]);
-            timestamps.add(audioDetector.timestamps[i]);
+            deviations.add(detector.deviations[i]);
+            timestamps.add(detector.timestamps[i]);
+        }
+    }
+    
+    String response;
+    serializeJson(doc, response);
+    
+    httpServer.send(200, "application/json", response);
+}
+
+void handleAudioCalibration() {
+    bootProfiler.markFirstCommand();
+    
+    // CORS headers
+    httpServer.sendHeader("Access-Control-Allow-Origin", "*");
+    httpServer.sendHeader("Access-Control-Allow-Methods", "GET, POST, OPTIONS");
+    httpServer.sendHeader("Access-Control-Allow-Headers", "Content-Type");
+    
+    int ch = getRequestedAudioChannel();
+    if (ch < 0 || audioChannels[ch].is_digital) {
+        httpServer.send(400, "application/json", "{\"error\":\"invalid channel\"}");
+        return;
+    }
+    AudioChannel& channel = audioChannels[ch];
+    AudioFrontEnd& frontEnd = channel.frontEnd;
+    
+    // ?restart=1 でキャリブレーションをやり直す
+    if (httpServer.hasArg("restart") && httpServer.arg("restart") != "0") {
+        frontEnd.requestCalibration();
+        Serial.printf("Audio ch%d calibration restarted (HTTP)\n", ch);
+    }
+    
+    DynamicJsonDocument doc(512);
+    
+    doc["channel"] = ch;
+    doc["calibrating"] = frontEnd.isCalibrating();
+    doc["dc_level"] = frontEnd.dcLevel();
+    doc["envelope"] = frontEnd.envelopeLevel();
+    doc["noise_floor"] = frontEnd.noiseFloor();
+    doc["peak"] = frontEnd.peakLevel();
+    doc["threshold_high"] = frontEnd.thresholdHigh();
+    doc["threshold_low"] = frontEnd.thresholdLow();
+    
+    String response;
+    serializeJson(doc, response);
+    
+    httpServer.send(200, "application/json", response);
+}
+
+void handleAudioChannels() {
+    bootProfiler.markFirstCommand();
+    
+    // CORS headers
+    httpServer.sendHeader("Access-Control-Allow-Origin", "*");
+    httpServer.sendHeader("Access-Control-Allow-Methods", "GET, POST, OPTIONS");
+    httpServer.sendHeader("Access-Control-Allow-Headers", "Content-Type");
+    
+    // ?ch=N&enabled=0|1&period=ms でチャネル設定を変更（検出器はリセット）
+    if (httpServer.hasArg("ch") && (httpServer.hasArg("enabled") || httpServer.hasArg("period"))) {
+        int ch = getRequestedAudioChannel();
+        if (ch < 0) {
+            httpServer.send(400, "application/json", "{\"error\":\"invalid channel\"}");
+            return;
+        }
+        const AudioChannel& channel = audioChannels[ch];
+        
+        // HTTPはloop()タスク上で処理されるため直接適用できる
+        bool enabled = channel.enabled;
+        if (httpServer.hasArg("enabled")) {
+            enabled = (httpServer.arg("enabled") != "0");
+        }
+        int period = 0;
+        if (httpServer.hasArg("period")) {
+            period = httpServer.arg("period").toInt();
         }
+        applyAudioChannelConfig(ch, enabled, period > 0 ? period : 0, millis());
+    }
+    
+    DynamicJsonDocument doc(1024);
+    JsonArray channels = doc.createNestedArray("channels");
+    
+    for (uint8_t ch = 0; ch < AUDIO_CHANNEL_COUNT; ch++) {
+        const AudioChannel& channel = audioChannels[ch];
+        JsonObject entry = channels.createNestedObject();
+        entry["channel"] = ch;
+        entry["pin"] = channel.pin;
+        entry["digital"] = channel.is_digital;
+        entry["enabled"] = channel.enabled;
+        entry["expected_period"] = channel.detector.expected_period;
+        entry["signal_count"] = channel.detector.signal_count;
+        entry["first_signal_time"] = channel.detector.first_signal_time;
+        entry["max_abs_deviation"] = channel.detector.max_abs_deviation;
+        entry["mean_abs_deviation"] = channel.detector.meanAbsDeviation();
+    }
+    
+    String response;
+    serializeJson(doc, response);
+    
+    httpServer.send(200, "application/json", response);
+}
+
+void handleBootProfile() {
+    // CORS headers
+    httpServer.sendHeader("Access-Control-Allow-Origin", "*");
+    httpServer.sendHeader("Access-Control-Allow-Methods", "GET, POST, OPTIONS");
+    httpServer.sendHeader("Access-Control-Allow-Headers", "Content-Type");
+    
+    BootProfiler profile = bootProfiler.snapshot();
+    DynamicJsonDocument doc(1024);
+    
+    doc["ble_first"] = BOOT_BLE_FIRST;
+    doc["wifi_boot_mode"] = WIFI_BOOT_MODE;
+    doc["setup_us"] = profile.setup_end_us - profile.setup_start_us;
+    doc["ble_ready_us"] = profile.ble_ready_us;
+    doc["http_ready_us"] = profile.http_ready_us;
+    doc["first_command_us"] = profile.first_command_us;
+    
+    JsonArray phases = doc.createNestedArray("phases");
+    for (uint8_t i = 0; i < profile.phase_count; i++) {
+        JsonObject entry = phases.createNestedObject();
+        entry["name"] = profile.phases[i].name;
+        entry["start_us"] = profile.phases[i].start_us;
+        entry["duration_us"] = profile.phases[i].duration_us;
     }
     
     String response;
@@ -0,0 +1,598 @@
+// 測定結果オフライン解析ツール (ホストPC用)
+//
+// app.js の CSV エクスポート、または ESP32 の結果バイナリダンプを読み込み、
+// 偏差系列のスペクトル (Welch法FFT, Hann窓・50%重複)、Allan偏差、ヒストグラム、パーセンタイルを出力する。
+// ファイルは1行/1フレームずつ読み込み、統計はすべて固定サイズのバッファで逐次計算する。
+// 複数ファイルはスレッドで並列に解析する。
+//
+// ビルド:
+//   g++ -std=c++17 -O2 -pthread -o jitter_analyzer tools/jitter_analyzer.cpp
+//
+// 入力形式:
+//   *.csv  ヘッダー行の列名で偏差列を選択 (既定: Deviation_ms)
+//   *.bin  GET_RESULTS (0x05) 応答の連結 [count:2][偏差int16 × count] (リトルエンディアン, ms)
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <complex>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr size_t kMinFftSize = 16;  // 短い測定で1セグメントに縮めるときの下限
+
+struct Options {
+    double period_ms = 75.0;         // サンプル間隔 (信号周期)
+    std::string column = "Deviation_ms";
+    size_t fft_size = 64;            // Welch法のセグメント長 (2のべき乗、既定の100信号でも複数セグメント)
+    size_t max_allan_m = 1 << 14;    // Allan偏差の最大平均化係数
+    double bin_width_ms = 0.1;       // ヒストグラム/パーセンタイルの分解能
+    double histogram_range_ms = 500; // ヒストグラム範囲 (±)
+    double tolerance_ms = 10.0;      // 許容範囲 (ESP32側のmax_deviationと同じ既定値)
+    size_t spectrum_peaks = 5;
+    unsigned jobs = 0;               // 0: ハードウェアスレッド数
+    bool summary = false;            // 1ファイル1行のCSVで出力
+};
+
+// 基数2の反復FFT (in-place)
+void fft(std::vector<std::complex<double>>& data) {
+    const size_t n = data.size();
+    for (size_t i = 1, j = 0; i < n; i++) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) std::swap(data[i], data[j]);
+    }
+    for (size_t len = 2; len <= n; len <<= 1) {
+        const double angle = -2.0 * kPi / len;
+        const std::complex<double> wlen(std::cos(angle), std::sin(angle));
+        for (size_t i = 0; i < n; i += len) {
+            std::complex<double> w(1.0, 0.0);
+            for (size_t k = 0; k < len / 2; k++) {
+                const std::complex<double> u = data[i + k];
+                const std::complex<double> v = data[i + k + len / 2] * w;
+                data[i + k] = u + v;
+                data[i + k + len / 2] = u - v;
+                w *= wlen;
+            }
+        }
+    }
+}
+
+// 偏差系列を1サンプルずつ受け取り、全統計を逐次更新する
+class JitterAnalyzer {
+public:
+    explicit JitterAnalyzer(const Options& options)
+        : options_(options),
+          segment_(),
+          history_(2 * options.max_allan_m + 1, 0.0),
+          histogram_(static_cast<size_t>(2 * options.histogram_range_ms / options.bin_width_ms) + 1, 0) {
+        segment_.reserve(options.fft_size);
+        setSpectrumSize(options.fft_size);
+        for (size_t m = 1; m <= options.max_allan_m; m <<= 1) {
+            allan_.push_back({m, 0.0, 0});
+        }
+    }
+
+    void push(double x) {
+        // NaN/infは統計を壊すため数えるだけで除外
+        if (!std::isfinite(x)) {
+            non_finite_++;
+            return;
+        }
+
+        // 基本統計 (Welford法)
+        count_++;
+        const double delta = x - mean_;
+        mean_ += delta / count_;
+        m2_ += delta * (x - mean_);
+        min_ = std::min(min_, x);
+        max_ = std::max(max_, x);
+        if (std::fabs(x) <= options_.tolerance_ms) within_tolerance_++;
+
+        // ヒストグラム
+        // 整数msのデータがビン境界の丸め誤差で一つ下のビンに入らないよう僅かに補正
+        const double position = (x + options_.histogram_range_ms) / options_.bin_width_ms + 1e-9;
+        if (position < 0) {
+            underflow_++;
+        } else if (position >= histogram_.size()) {
+            overflow_++;
+        } else {
+            histogram_[static_cast<size_t>(position)]++;
+        }
+
+        // Allan偏差 (時間偏差x_iから二階差分を計算、重複あり)
+        history_[(count_ - 1) % history_.size()] = x;
+        for (auto& entry : allan_) {
+            if (count_ <= 2 * entry.m) break;
+            const double x0 = history_[(count_ - 1 - 2 * entry.m) % history_.size()];
+            const double x1 = history_[(count_ - 1 - entry.m) % history_.size()];
+            const double d = x - 2.0 * x1 + x0;
+            entry.sum += d * d;
+            entry.terms++;
+        }
+
+        // スペクトル (セグメントが揃ったらFFT、次のセグメントと50%重複させる)
+        segment_.push_back(x);
+        if (segment_.size() == options_.fft_size) {
+            accumulateSegment();
+            segment_.erase(segment_.begin(), segment_.begin() + options_.fft_size / 2);
+        }
+    }
+
+    // 入力終了時に呼ぶ。セグメントが一度も揃わない短い測定は、
+    // 末尾の2のべき乗個のサンプルで1セグメントだけスペクトルを求める
+    void finish() {
+        if (segments_ > 0) return;
+        size_t size = options_.fft_size;
+        while (size > segment_.size() && size > kMinFftSize) size >>= 1;
+        if (size > segment_.size()) return;
+
+        segment_.erase(segment_.begin(), segment_.end() - size);
+        setSpectrumSize(size);
+        accumulateSegment();
+    }
+
+    uint64_t count() const { return count_; }
+    uint64_t nonFinite() const { return non_finite_; }
+    double mean() const { return mean_; }
+    double stddev() const { return count_ > 1 ? std::sqrt(m2_ / (count_ - 1)) : 0.0; }
+    double min() const { return min_; }
+    double max() const { return max_; }
+    double withinTolerancePercent() const { return count_ ? 100.0 * within_tolerance_ / count_ : 0.0; }
+
+    // ヒストグラムからパーセンタイルを求める (分解能はbin_width_ms、該当ビンの下端を返す)
+    double percentile(double p) const {
+        if (count_ == 0) return 0.0;
+        const uint64_t target = static_cast<uint64_t>(std::ceil(p / 100.0 * count_));
+        uint64_t seen = underflow_;
+        if (seen >= target) return min_;
+        for (size_t i = 0; i < histogram_.size(); i++) {
+            seen += histogram_[i];
+            if (seen >= target) {
+                const double lower = -options_.histogram_range_ms + i * options_.bin_width_ms;
+                return std::min(std::max(lower, min_), max_);
+            }
+        }
+        return max_;
+    }
+
+    struct AllanPoint {
+        double tau_s;
+        double deviation;
+    };
+
+    std::vector<AllanPoint> allanDeviation() const {
+        std::vector<AllanPoint> points;
+        for (const auto& entry : allan_) {
+            if (entry.terms == 0) break;
+            const double tau_ms = entry.m * options_.period_ms;
+            const double variance = entry.sum / (2.0 * tau_ms * tau_ms * entry.terms);
+            points.push_back({tau_ms / 1000.0, std::sqrt(variance)});
+        }
+        return points;
+    }
+
+    struct SpectrumPeak {
+        double frequency_hz;
+        double amplitude_ms;
+    };
+
+    // 平均パワースペクトルの極大値を振幅順に返す (DC成分は除く)
+    std::vector<SpectrumPeak> spectrumPeaks() const {
+        std::vector<SpectrumPeak> peaks;
+        if (segments_ == 0) return peaks;
+
+        const double sample_rate = 1000.0 / options_.period_ms;
+        const double bin_hz = sample_rate / window_.size();
+        for (size_t k = 1; k + 1 < power_.size(); k++) {
+            if (power_[k] > power_[k - 1] && power_[k] >= power_[k + 1]) {
+                // 片側振幅スペクトル (窓の総和で正規化した正弦波振幅)
+                const double amplitude = 2.0 * std::sqrt(power_[k] / segments_) / window_sum_;
+                peaks.push_back({k * bin_hz, amplitude});
+            }
+        }
+        std::sort(peaks.begin(), peaks.end(),
+                  [](const SpectrumPeak& a, const SpectrumPeak& b) { return a.amplitude_ms > b.amplitude_ms; });
+        if (peaks.size() > options_.spectrum_peaks) peaks.resize(options_.spectrum_peaks);
+        return peaks;
+    }
+
+    size_t segments() const { return segments_; }
+    size_t spectrumSize() const { return window_.size(); }
+
+    // 表示用に粗いビン (width_ms) へ集約したヒストグラム
+    std::vector<std::pair<double, uint64_t>> coarseHistogram(double width_ms) const {
+        std::vector<std::pair<double, uint64_t>> bins;
+        const size_t factor = std::max<size_t>(1, static_cast<size_t>(std::round(width_ms / options_.bin_width_ms)));
+        for (size_t i = 0; i < histogram_.size(); i += factor) {
+            uint64_t total = 0;
+            for (size_t j = i; j < std::min(i + factor, histogram_.size()); j++) {
+                total += histogram_[j];
+            }
+            if (total > 0) {
+                bins.push_back({-options_.histogram_range_ms + i * options_.bin_width_ms, total});
+            }
+        }
+        return bins;
+    }
+
+    uint64_t underflow() const { return underflow_; }
+    uint64_t overflow() const { return overflow_; }
+
+private:
+    struct AllanAccumulator {
+        size_t m;
+        double sum;
+        uint64_t terms;
+    };
+
+    void setSpectrumSize(size_t size) {
+        power_.assign(size / 2 + 1, 0.0);
+        window_.resize(size);
+        window_sum_ = 0.0;
+        for (size_t i = 0; i < size; i++) {
+            window_[i] = 0.5 - 0.5 * std::cos(2.0 * kPi * i / (size - 1)); // Hann窓
+            window_sum_ += window_[i];
+        }
+    }
+
+    void accumulateSegment() {
+        // セグメント内の平均を除いてから窓掛け
+        double segment_mean = 0.0;
+        for (double v : segment_) segment_mean += v;
+        segment_mean /= segment_.size();
+
+        std::vector<std::complex<double>> data(segment_.size());
+        for (size_t i = 0; i < segment_.size(); i++) {
+            data[i] = (segment_[i] - segment_mean) * window_[i];
+        }
+        fft(data);
+        for (size_t k = 0; k < power_.size(); k++) {
+            power_[k] += std::norm(data[k]);
+        }
+        segments_++;
+    }
+
+    const Options& options_;
+
+    uint64_t count_ = 0;
+    double mean_ = 0.0;
+    double m2_ = 0.0;
+    double min_ = std::numeric_limits<double>::infinity();
+    double max_ = -std::numeric_limits<double>::infinity();
+    uint64_t within_tolerance_ = 0;
+    uint64_t non_finite_ = 0;
+
+    std::vector<double> segment_;
+    std::vector<double> power_;
+    std::vector<double> window_;
+    double window_sum_ = 0.0;
+    size_t segments_ = 0;
+
+    std::vector<double> history_;
+    std::vector<AllanAccumulator> allan_;
+
+    std::vector<uint64_t> histogram_;
+    uint64_t underflow_ = 0;
+    uint64_t overflow_ = 0;
+};
+
+bool endsWith(const std::string& value, const std::string& suffix) {
+    return value.size() >= suffix.size() &&
+           value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+std::vector<std::string> splitCsvLine(const std::string& line) {
+    std::vector<std::string> fields;
+    std::string field;
+    std::istringstream stream(line);
+    while (std::getline(stream, field, ',')) {
+        if (!field.empty() && field.back() == '\r') field.pop_back();
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+// CSVを1行ずつ読み、指定列の値を解析器に渡す
+bool readCsv(const std::string& path, const Options& options, JitterAnalyzer& analyzer, std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "cannot open file";
+        return false;
+    }
+
+    std::string line;
+    if (!std::getline(file, line)) {
+        error = "empty file";
+        return false;
+    }
+
+    const std::vector<std::string> headers = splitCsvLine(line);
+    auto it = std::find(headers.begin(), headers.end(), options.column);
+    if (it == headers.end()) {
+        error = "column not found: " + options.column;
+        return false;
+    }
+    const size_t column = it - headers.begin();
+
+    while (std::getline(file, line)) {
+        const std::vector<std::string> fields = splitCsvLine(line);
+        if (column >= fields.size() || fields[column].empty()) continue;
+
+        char* end = nullptr;
+        const double value = std::strtod(fields[column].c_str(), &end);
+        if (end == fields[column].c_str()) continue;
+        analyzer.push(value);
+    }
+    return true;
+}
+
+// GET_RESULTS応答 [count:2][int16 × count] の連結を読む
+bool readBinary(const std::string& path, JitterAnalyzer& analyzer, std::string& error) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        error = "cannot open file";
+        return false;
+    }
+
+    uint8_t header[2];
+    std::vector<uint8_t> payload;
+    while (file.read(reinterpret_cast<char*>(header), sizeof(header))) {
+        const uint16_t count = header[0] | (header[1] << 8);
+        payload.resize(count * 2);
+        if (!file.read(reinterpret_cast<char*>(payload.data()), payload.size())) {
+            error = "truncated frame";
+            return false;
+        }
+        for (uint16_t i = 0; i < count; i++) {
+            const int16_t deviation = static_cast<int16_t>(payload[i * 2] | (payload[i * 2 + 1] << 8));
+            analyzer.push(deviation);
+        }
+    }
+    return true;
+}
+
+struct FileReport {
+    std::string path;
+    bool ok = false;
+    std::string error;
+    std::string text;
+};
+
+void appendf(std::string& out, const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+void appendf(std::string& out, const char* format, ...) {
+    char buffer[512];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    out += buffer;
+}
+
+void formatReport(const Options& options, const JitterAnalyzer& analyzer, FileReport& report) {
+    std::string& out = report.text;
+
+    if (options.summary) {
+        // 求められなかった統計値は0ではなく空欄にする (「測定して0」と区別するため)
+        appendf(out, "%s,%llu,%llu", report.path.c_str(), static_cast<unsigned long long>(analyzer.count()),
+                static_cast<unsigned long long>(analyzer.nonFinite()));
+        if (analyzer.count() == 0) {
+            out += ",,,,,,,,,,,,\n";
+            return;
+        }
+        appendf(out, ",%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.1f",
+                analyzer.mean(), analyzer.stddev(), analyzer.min(), analyzer.max(),
+                analyzer.percentile(50), analyzer.percentile(99), analyzer.percentile(99.9),
+                analyzer.withinTolerancePercent());
+
+        auto peaks = analyzer.spectrumPeaks();
+        if (peaks.empty()) {
+            out += ",,";
+        } else {
+            appendf(out, ",%.4f,%.4f", peaks[0].frequency_hz, peaks[0].amplitude_ms);
+        }
+
+        // 到達できる最長のτはファイル長で変わるため、τも併記する
+        auto allan = analyzer.allanDeviation();
+        if (allan.empty()) {
+            out += ",,\n";
+        } else {
+            appendf(out, ",%.3f,%.3e\n", allan.back().tau_s, allan.back().deviation);
+        }
+        return;
+    }
+
+    appendf(out, "=== %s ===\n", report.path.c_str());
+    appendf(out, "Samples: %llu\n", static_cast<unsigned long long>(analyzer.count()));
+    if (analyzer.nonFinite()) {
+        appendf(out, "Skipped non-finite values: %llu\n", static_cast<unsigned long long>(analyzer.nonFinite()));
+    }
+    if (analyzer.count() == 0) return;
+
+    appendf(out, "Mean: %.3f ms, StdDev: %.3f ms, Min: %.3f ms, Max: %.3f ms\n",
+            analyzer.mean(), analyzer.stddev(), analyzer.min(), analyzer.max());
+    appendf(out, "Within tolerance (+/-%.1f ms): %.1f%%\n", options.tolerance_ms, analyzer.withinTolerancePercent());
+
+    appendf(out, "\nPercentiles (resolution %.2f ms):\n", options.bin_width_ms);
+    const double percentiles[] = {1, 5, 25, 50, 75, 95, 99, 99.9};
+    for (double p : percentiles) {
+        appendf(out, "  p%-5g %9.2f ms\n", p, analyzer.percentile(p));
+    }
+
+    appendf(out, "\nHistogram (1 ms bins):\n");
+    for (const auto& bin : analyzer.coarseHistogram(1.0)) {
+        appendf(out, "  %+8.1f ms %10llu\n", bin.first, static_cast<unsigned long long>(bin.second));
+    }
+    if (analyzer.underflow() || analyzer.overflow()) {
+        appendf(out, "  out of range: %llu below, %llu above\n",
+                static_cast<unsigned long long>(analyzer.underflow()),
+                static_cast<unsigned long long>(analyzer.overflow()));
+    }
+
+    appendf(out, "\nSpectrum peaks (%zu segments x %zu samples, fs = %.3f Hz):\n",
+            analyzer.segments(), analyzer.spectrumSize(), 1000.0 / options.period_ms);
+    const auto peaks = analyzer.spectrumPeaks();
+    if (analyzer.segments() == 0) {
+        appendf(out, "  no spectrum (fewer than %zu samples)\n", kMinFftSize);
+    } else if (peaks.empty()) {
+        out += "  no peaks\n";
+    }
+    for (const auto& peak : peaks) {
+        appendf(out, "  %8.4f Hz (period %9.1f ms)  amplitude %.3f ms\n",
+                peak.frequency_hz, 1000.0 / peak.frequency_hz, peak.amplitude_ms);
+    }
+
+    appendf(out, "\nAllan deviation:\n");
+    for (const auto& point : analyzer.allanDeviation()) {
+        appendf(out, "  tau %10.3f s  %.3e\n", point.tau_s, point.deviation);
+    }
+    out += "\n";
+}
+
+void analyzeFile(const Options& options, FileReport& report) {
+    JitterAnalyzer analyzer(options);
+    if (endsWith(report.path, ".bin")) {
+        report.ok = readBinary(report.path, analyzer, report.error);
+    } else {
+        report.ok = readCsv(report.path, options, analyzer, report.error);
+    }
+    if (report.ok) {
+        analyzer.finish();
+        formatReport(options, analyzer, report);
+    }
+}
+
+void printUsage(const char* program) {
+    std::fprintf(stderr,
+                 "Usage: %s [options] <run.csv|run.bin>...\n"
+                 "  --period MS       signal period / sample interval (default 75)\n"
+                 "  --column NAME     CSV column to analyze (default Deviation_ms)\n"
+                 "  --fft-size N      Welch segment length, power of two (default 64; shorter runs use one\n"
+                 "                    segment of the largest power of two that fits)\n"
+                 "  --bin-width MS    histogram/percentile resolution (default 0.1)\n"
+                 "  --range MS        histogram range +/-MS (default 500)\n"
+                 "  --tolerance MS    tolerance for pass rate (default 10)\n"
+                 "  --jobs N          parallel files (default: hardware threads)\n"
+                 "  --summary         one CSV line per file\n",
+                 program);
+}
+
+bool parseOptions(int argc, char** argv, Options& options, std::vector<std::string>& files) {
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        auto next = [&](const char* name) -> const char* {
+            if (i + 1 >= argc) {
+                std::fprintf(stderr, "Missing value for %s\n", name);
+                return nullptr;
+            }
+            return argv[++i];
+        };
+
+        const char* value = nullptr;
+        if (arg == "--summary") {
+            options.summary = true;
+        } else if (arg == "--help" || arg == "-h") {
+            return false;
+        } else if (arg == "--period") {
+            if (!(value = next("--period"))) return false;
+            options.period_ms = std::atof(value);
+        } else if (arg == "--column") {
+            if (!(value = next("--column"))) return false;
+            options.column = value;
+        } else if (arg == "--fft-size") {
+            if (!(value = next("--fft-size"))) return false;
+            options.fft_size = std::strtoul(value, nullptr, 10);
+        } else if (arg == "--bin-width") {
+            if (!(value = next("--bin-width"))) return false;
+            options.bin_width_ms = std::atof(value);
+        } else if (arg == "--range") {
+            if (!(value = next("--range"))) return false;
+            options.histogram_range_ms = std::atof(value);
+        } else if (arg == "--tolerance") {
+            if (!(value = next("--tolerance"))) return false;
+            options.tolerance_ms = std::atof(value);
+        } else if (arg == "--jobs") {
+            if (!(value = next("--jobs"))) return false;
+            options.jobs = std::strtoul(value, nullptr, 10);
+        } else if (!arg.empty() && arg[0] == '-') {
+            std::fprintf(stderr, "Unknown option: %s\n", arg.c_str());
+            return false;
+        } else {
+            files.push_back(arg);
+        }
+    }
+
+    if (options.fft_size < 4 || (options.fft_size & (options.fft_size - 1)) != 0) {
+        std::fprintf(stderr, "--fft-size must be a power of two >= 4\n");
+        return false;
+    }
+    if (options.period_ms <= 0 || options.bin_width_ms <= 0 || options.histogram_range_ms <= 0) {
+        std::fprintf(stderr, "--period, --bin-width and --range must be positive\n");
+        return false;
+    }
+    return !files.empty();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    std::vector<std::string> files;
+    if (!parseOptions(argc, argv, options, files)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    std::vector<FileReport> reports(files.size());
+    for (size_t i = 0; i < files.size(); i++) {
+        reports[i].path = files[i];
+    }
+
+    // ファイル単位で並列解析 (出力は入力順)
+    unsigned jobs = options.jobs ? options.jobs : std::max(1u, std::thread::hardware_concurrency());
+    jobs = std::min<unsigned>(jobs, files.size());
+    std::atomic<size_t> next_file(0);
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < jobs; t++) {
+        workers.emplace_back([&]() {
+            for (size_t i = next_file++; i < reports.size(); i = next_file++) {
+                analyzeFile(options, reports[i]);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    if (options.summary) {
+        std::printf("file,samples,skipped_non_finite,mean_ms,stddev_ms,min_ms,max_ms,p50_ms,p99_ms,p999_ms,"
+                    "within_tolerance_pct,peak_hz,peak_amplitude_ms,adev_tau_s,adev\n");
+    }
+
+    int failures = 0;
+    for (const auto& report : reports) {
+        if (!report.ok) {
+            std::fprintf(stderr, "%s: %s\n", report.path.c_str(), report.error.c_str());
+            failures++;
+            continue;
+        }
+        std::fputs(report.text.c_str(), stdout);
+    }
+    return failures ? 1 : 0;
+}